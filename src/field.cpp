@@ -0,0 +1,97 @@
+/**
+ * Модуль разреженного игрового поля, разбитого на чанки
+ */
+
+#include <algorithm>
+#include "field.h"
+
+using namespace std;
+
+/// @brief Основной конструктор поля
+/// @param width Ширина поля (в пикселях)
+/// @param height Высота поля (в пикселях)
+/// @param chunkWidth Ширина одного чанка (в пикселях)
+/// @param chunkHeight Высота одного чанка (в пикселях)
+Field::Field(int width, int height, int chunkWidth, int chunkHeight) :
+    width_(width), height_(height), chunk_width_(chunkWidth), chunk_height_(chunkHeight)
+{
+}
+
+/// @brief Возвращает номер чанка, в котором находится точка
+/// @param pos Координаты точки (x,y)
+/// @return Номер чанка (столбец, строка)
+pair<int,int> Field::chunkOf(pair<int,int> pos) const
+{
+    // Деление с округлением вниз, чтобы точки за левой и верхней
+    // границами поля попадали в свои чанки, а не в нулевой
+    auto floorDiv = [](int value, int size) {
+        return value >= 0 ? value / size : (value - size + 1) / size;
+    };
+    return {floorDiv(pos.first, chunk_width_), floorDiv(pos.second, chunk_height_)};
+}
+
+/// @brief Возвращает ключ чанка для хранения в таблице чанков
+/// @param chunk Номер чанка (столбец, строка)
+/// @return Ключ чанка
+int64_t Field::chunkKey(pair<int,int> chunk)
+{
+    return (int64_t)(((uint64_t)(uint32_t)chunk.first << 32) | (uint32_t)chunk.second);
+}
+
+/// @brief Удаляет все объекты с поля
+void Field::clear()
+{
+    this->chunks_.clear();
+}
+
+/// @brief Добавляет объект на поле
+/// @param pos Координаты объекта (x,y)
+void Field::add(pair<int,int> pos)
+{
+    this->chunks_[chunkKey(this->chunkOf(pos))].push_back(pos);
+}
+
+/// @brief Удаляет с поля один объект в указанной позиции.
+/// Чанк, в котором не осталось объектов, освобождается
+/// @param pos Координаты объекта (x,y)
+void Field::remove(pair<int,int> pos)
+{
+    auto chunk = this->chunks_.find(chunkKey(this->chunkOf(pos)));
+    if (chunk == this->chunks_.end()) {
+        return;
+    }
+    auto &objects = chunk->second;
+    auto it = std::find(objects.begin(), objects.end(), pos);
+    if (it == objects.end()) {
+        return;
+    }
+    // Порядок объектов внутри чанка не важен
+    *it = objects.back();
+    objects.pop_back();
+    if (objects.empty()) {
+        this->chunks_.erase(chunk);
+    }
+}
+
+/// @brief Возвращает объекты из всех чанков, пересекающихся с указанной областью.
+/// Просматриваются только эти чанки, поэтому время не зависит от размера поля
+/// @param area Область поиска (в пикселях)
+/// @return Координаты объектов (x,y)
+vector<pair<int,int>> Field::find(const QRect &area) const
+{
+    vector<pair<int,int>> result;
+    if (area.isEmpty() || this->chunks_.empty()) {
+        return result;
+    }
+    auto [first_col, first_row] = this->chunkOf({area.left(), area.top()});
+    auto [last_col, last_row] = this->chunkOf({area.right(), area.bottom()});
+    for (int row = first_row; row <= last_row; ++row) {
+        for (int col = first_col; col <= last_col; ++col) {
+            auto chunk = this->chunks_.find(chunkKey({col, row}));
+            if (chunk != this->chunks_.end()) {
+                result.insert(result.end(), chunk->second.begin(), chunk->second.end());
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <QRect>
+
+using namespace std;
+
+/// @brief Класс разреженного игрового поля. Поле разбито на чанки
+/// фиксированного размера, память выделяется только под чанки,
+/// в которых есть объекты
+class Field {
+private:
+    // Ширина поля (в пикселях)
+    int width_;
+    // Высота поля (в пикселях)
+    int height_;
+    // Ширина одного чанка (в пикселях)
+    int chunk_width_;
+    // Высота одного чанка (в пикселях)
+    int chunk_height_;
+    // Непустые чанки. Ключ - номер чанка (столбец, строка),
+    // значение - координаты объектов (x,y), лежащих в чанке
+    unordered_map<int64_t, vector<pair<int,int>>> chunks_;
+    // Метод возвращает номер чанка (столбец, строка), в котором находится точка
+    pair<int,int> chunkOf(pair<int,int> pos) const;
+    // Метод возвращает ключ чанка по его номеру
+    static int64_t chunkKey(pair<int,int> chunk);
+public:
+    // Основной конструктор поля
+    Field(int width = 0, int height = 0, int chunkWidth = 1, int chunkHeight = 1);
+    // Возвращает ширину поля
+    int width() const { return width_; };
+    // Возвращает высоту поля
+    int height() const { return height_; };
+    // Возвращает количество непустых чанков
+    size_t chunksCount() const { return chunks_.size(); };
+    // Метод удаляет все объекты с поля
+    void clear();
+    // Метод добавляет объект в указанной позиции
+    void add(pair<int,int> pos);
+    // Метод удаляет один объект в указанной позиции
+    void remove(pair<int,int> pos);
+    // Метод возвращает объекты из чанков, пересекающихся с областью
+    vector<pair<int,int>> find(const QRect &area) const;
+};
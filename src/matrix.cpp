@@ -6,6 +6,62 @@
 #include "matrix.h"
 #include <iostream>
 #include <math.h>
+#include <thread>
+#include <algorithm>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <atomic>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Количество точек, начиная с которого преобразование
+// распределяется по нескольким потокам
+#define TRANSFORM_PARALLEL_THRESHOLD 65536
+
+// Сигнатура двоичного файла матрицы
+#define MATRIX_FILE_MAGIC "MTRX"
+// Версия формата двоичного файла матрицы
+#define MATRIX_FILE_VERSION 1
+// Маркер порядка байт. Записывается в порядке байт системы,
+// поэтому при чтении на системе с другим порядком читается как 0x04030201
+#define MATRIX_FILE_ENDIAN 0x01020304u
+
+// Типы элементов в двоичном файле матрицы
+enum MatrixDType : uint32_t
+{
+    MATRIX_FLOAT32 = 1,
+    MATRIX_FLOAT64 = 2
+};
+
+// Заголовок двоичного файла матрицы (32 байта, данные
+// идут сразу за ним и выровнены по 8 байт)
+struct MatrixFileHeader
+{
+    // Сигнатура "MTRX"
+    char magic[4];
+    // Маркер порядка байт
+    uint32_t endian;
+    // Версия формата
+    uint32_t version;
+    // Тип элементов
+    uint32_t dtype;
+    // Количество строк
+    uint64_t rows;
+    // Количество столбцов
+    uint64_t cols;
+};
+static_assert(sizeof(MatrixFileHeader) == 32, "Matrix file header must be 32 bytes");
 
 /// @brief Оператор индексации матрицы
 /// @param row Строка
@@ -170,4 +226,453 @@ Matrix &Matrix::operator*=(const Matrix &A)
 {
     *this = *this * A;
     return *this;
-}
\ No newline at end of file
+}
+
+/// @brief Применяет аффинное преобразование к диапазону точек на месте (один поток)
+/// @param m Коэффициенты первых двух строк матрицы преобразования (m00,m01,m02,m10,m11,m12)
+/// @param xs Массив координат X
+/// @param ys Массив координат Y
+/// @param count Количество точек
+static void transformPointsKernel(const real m[6], real *xs, real *ys, size_t count)
+{
+    size_t idx = 0;
+#if defined(__AVX__)
+    // Обрабатываем по 4 точки за одну итерацию
+    const __m256d a00 = _mm256_set1_pd(m[0]), a01 = _mm256_set1_pd(m[1]), a02 = _mm256_set1_pd(m[2]);
+    const __m256d a10 = _mm256_set1_pd(m[3]), a11 = _mm256_set1_pd(m[4]), a12 = _mm256_set1_pd(m[5]);
+    for (; idx + 4 <= count; idx += 4)
+    {
+        __m256d x = _mm256_loadu_pd(xs + idx);
+        __m256d y = _mm256_loadu_pd(ys + idx);
+        __m256d nx = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a00, x), _mm256_mul_pd(a01, y)), a02);
+        __m256d ny = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a10, x), _mm256_mul_pd(a11, y)), a12);
+        _mm256_storeu_pd(xs + idx, nx);
+        _mm256_storeu_pd(ys + idx, ny);
+    }
+#elif defined(__SSE2__)
+    // Обрабатываем по 2 точки за одну итерацию
+    const __m128d a00 = _mm_set1_pd(m[0]), a01 = _mm_set1_pd(m[1]), a02 = _mm_set1_pd(m[2]);
+    const __m128d a10 = _mm_set1_pd(m[3]), a11 = _mm_set1_pd(m[4]), a12 = _mm_set1_pd(m[5]);
+    for (; idx + 2 <= count; idx += 2)
+    {
+        __m128d x = _mm_loadu_pd(xs + idx);
+        __m128d y = _mm_loadu_pd(ys + idx);
+        __m128d nx = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a00, x), _mm_mul_pd(a01, y)), a02);
+        __m128d ny = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a10, x), _mm_mul_pd(a11, y)), a12);
+        _mm_storeu_pd(xs + idx, nx);
+        _mm_storeu_pd(ys + idx, ny);
+    }
+#endif
+    // Оставшиеся точки обрабатываем по одной
+    for (; idx < count; ++idx)
+    {
+        real x = xs[idx], y = ys[idx];
+        xs[idx] = m[0] * x + m[1] * y + m[2];
+        ys[idx] = m[3] * x + m[4] * y + m[5];
+    }
+}
+
+/// @brief Применяет аффинное преобразование (текущая матрица 3x3) к массиву точек на месте.
+/// Точки хранятся в виде двух отдельных массивов координат X и Y. Каждая точка
+/// рассматривается как столбец (x,y,1), который умножается на матрицу слева
+/// @param xs Массив координат X
+/// @param ys Массив координат Y
+/// @param count Количество точек
+void Matrix::transformPoints(real *xs, real *ys, size_t count) const
+{
+    if (this->rows_ != 3 || this->cols_ != 3)
+    {
+        std::cerr << "Matrix: transform matrix must be 3x3" << std::endl;
+        return;
+    }
+    // Последняя строка аффинной матрицы (0,0,1) не нужна
+    const real *a = this->data();
+    const real m[6] = {a[0], a[1], a[2], a[3], a[4], a[5]};
+    Matrix::transformPoints(m, xs, ys, count);
+}
+
+/// @brief Применяет аффинное преобразование к массиву точек на месте.
+/// Матрица передается коэффициентами первых двух строк, поэтому вызов
+/// не требует создания объекта Matrix и выделения памяти.
+/// При большом количестве точек работа распределяется по нескольким потокам
+/// @param m Коэффициенты (m00,m01,m02,m10,m11,m12)
+/// @param xs Массив координат X
+/// @param ys Массив координат Y
+/// @param count Количество точек
+void Matrix::transformPoints(const real m[6], real *xs, real *ys, size_t count)
+{
+    if (count < TRANSFORM_PARALLEL_THRESHOLD)
+    {
+        transformPointsKernel(m, xs, ys, count);
+        return;
+    }
+    // Количество ядер запрашиваем у системы только один раз
+    static const size_t cores_count = std::max(1u, std::thread::hardware_concurrency());
+    size_t threads_count = cores_count;
+    if (threads_count == 1)
+    {
+        transformPointsKernel(m, xs, ys, count);
+        return;
+    }
+    // Делим массив на равные части, последнюю часть обрабатываем в текущем потоке
+    threads_count = std::min(threads_count, count / (TRANSFORM_PARALLEL_THRESHOLD / 2));
+    size_t chunk = count / threads_count;
+    std::vector<std::thread> workers;
+    for (size_t idx = 0; idx < threads_count - 1; ++idx)
+    {
+        workers.emplace_back(transformPointsKernel, m, xs + idx * chunk, ys + idx * chunk, chunk);
+    }
+    size_t start = (threads_count - 1) * chunk;
+    transformPointsKernel(m, xs + start, ys + start, count - start);
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+
+/// @brief Меняет порядок байт значения на обратный
+/// @param value Указатель на значение
+/// @param size Размер значения в байтах
+static void swapBytes(void *value, size_t size)
+{
+    auto bytes = static_cast<unsigned char*>(value);
+    std::reverse(bytes, bytes + size);
+}
+
+/// @brief Читает и проверяет заголовок двоичного файла матрицы
+/// @param header Заголовок, прочитанный из файла. Поля приводятся к порядку байт системы
+/// @param swapped Устанавливается в true, если порядок байт в файле отличается от системного
+/// @return True если заголовок корректен
+static bool checkHeader(MatrixFileHeader &header, bool &swapped)
+{
+    if (std::memcmp(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        std::cerr << "Matrix: not a matrix file" << std::endl;
+        return false;
+    }
+    swapped = header.endian != MATRIX_FILE_ENDIAN;
+    if (swapped)
+    {
+        swapBytes(&header.endian, sizeof(header.endian));
+        swapBytes(&header.version, sizeof(header.version));
+        swapBytes(&header.dtype, sizeof(header.dtype));
+        swapBytes(&header.rows, sizeof(header.rows));
+        swapBytes(&header.cols, sizeof(header.cols));
+    }
+    if (header.endian != MATRIX_FILE_ENDIAN)
+    {
+        std::cerr << "Matrix: unknown byte order in matrix file" << std::endl;
+        return false;
+    }
+    if (header.version != MATRIX_FILE_VERSION)
+    {
+        std::cerr << "Matrix: unsupported matrix file version" << std::endl;
+        return false;
+    }
+    if (header.dtype != MATRIX_FLOAT32 && header.dtype != MATRIX_FLOAT64)
+    {
+        std::cerr << "Matrix: unsupported element type in matrix file" << std::endl;
+        return false;
+    }
+    if (header.rows > INT32_MAX || header.cols > INT32_MAX ||
+        (header.cols != 0 && header.rows > INT32_MAX / header.cols))
+    {
+        std::cerr << "Matrix: matrix in file is too large" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// @brief Возвращает код типа элементов, соответствующий типу real
+/// @return Код типа элементов
+static uint32_t realDType()
+{
+    return sizeof(real) == sizeof(float) ? MATRIX_FLOAT32 : MATRIX_FLOAT64;
+}
+
+/// @brief Создает пустой временный файл с уникальным именем рядом с указанным файлом
+/// @param filename Путь к итоговому файлу
+/// @param temp_filename Путь к созданному временному файлу (результат)
+/// @return True если файл создан
+static bool createTempFile(const std::string &filename, std::string &temp_filename)
+{
+#ifdef _WIN32
+    // Уникальность обеспечивают номер процесса и счетчик сохранений в нем
+    static std::atomic<unsigned> counter(0);
+    temp_filename = filename + "." + std::to_string(_getpid()) + "." + std::to_string(counter++) + ".tmp";
+    return (bool)std::ofstream(temp_filename, std::ios::binary | std::ios::trunc);
+#else
+    std::vector<char> path(filename.begin(), filename.end());
+    const char suffix[] = ".XXXXXX";
+    path.insert(path.end(), suffix, suffix + sizeof(suffix));
+    int fd = ::mkstemp(path.data());
+    if (fd < 0)
+    {
+        return false;
+    }
+    // mkstemp создает файл с правами 0600, а итоговый файл
+    // должен получить обычные права с учетом umask
+    mode_t mask = ::umask(0);
+    ::umask(mask);
+    ::fchmod(fd, 0666 & ~mask);
+    ::close(fd);
+    temp_filename = path.data();
+    return true;
+#endif
+}
+
+/// @brief Записывает матрицу в двоичный файл. Файл состоит из заголовка
+/// (размеры, тип элементов, порядок байт) и элементов матрицы, записанных
+/// одним блоком в порядке байт системы. Данные пишутся во временный файл
+/// с уникальным именем, который затем переименовывается в итоговый. Поэтому файл, отображенный
+/// в память (в том числе источник сохраняемых данных), не обрезается во время записи
+/// @param filename Путь к файлу
+/// @param rows Количество строк
+/// @param cols Количество столбцов
+/// @param data Элементы матрицы
+/// @return True если матрица успешно сохранена
+static bool writeMatrixFile(const std::string &filename, int rows, int cols, const real *data)
+{
+    std::string temp_filename;
+    if (!createTempFile(filename, temp_filename))
+    {
+        std::cerr << "Matrix: can't create temporary file for " << filename << std::endl;
+        return false;
+    }
+    std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "Matrix: can't open file " << temp_filename << " for writing" << std::endl;
+        std::remove(temp_filename.c_str());
+        return false;
+    }
+    MatrixFileHeader header;
+    std::memcpy(header.magic, MATRIX_FILE_MAGIC, sizeof(header.magic));
+    header.endian = MATRIX_FILE_ENDIAN;
+    header.version = MATRIX_FILE_VERSION;
+    header.dtype = realDType();
+    header.rows = (uint64_t)rows;
+    header.cols = (uint64_t)cols;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data), (std::streamsize)(sizeof(real) * rows * cols));
+    file.close();
+    if (!file)
+    {
+        std::cerr << "Matrix: can't write file " << temp_filename << std::endl;
+        std::remove(temp_filename.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    // В Windows rename не заменяет существующий файл
+    std::remove(filename.c_str());
+#endif
+    if (std::rename(temp_filename.c_str(), filename.c_str()) != 0)
+    {
+        std::cerr << "Matrix: can't replace file " << filename << std::endl;
+        std::remove(temp_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+/// @brief Сохраняет матрицу в двоичный файл
+/// @param filename Путь к файлу
+/// @return True если матрица успешно сохранена
+bool Matrix::save(const std::string &filename) const
+{
+    return writeMatrixFile(filename, this->rows_, this->cols_, this->data());
+}
+
+/// @brief Загружает матрицу из двоичного файла, изменяя ее размеры.
+/// Если порядок байт или тип элементов в файле отличаются от системных,
+/// данные преобразуются при чтении
+/// @param filename Путь к файлу
+/// @return True если матрица успешно загружена
+bool Matrix::load(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Matrix: can't open file " << filename << std::endl;
+        return false;
+    }
+    MatrixFileHeader header;
+    bool swapped = false;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        std::cerr << "Matrix: can't read header of file " << filename << std::endl;
+        return false;
+    }
+    if (!checkHeader(header, swapped))
+    {
+        return false;
+    }
+    size_t count = (size_t)(header.rows * header.cols);
+    size_t elem_size = header.dtype == MATRIX_FLOAT32 ? sizeof(float) : sizeof(double);
+    // Размеры из заголовка проверяем по длине файла до выделения памяти
+    file.seekg(0, std::ios::end);
+    std::streamoff length = file.tellg();
+    file.seekg(sizeof(header), std::ios::beg);
+    if (length < 0 || (uint64_t)length - sizeof(header) < count * elem_size)
+    {
+        std::cerr << "Matrix: file " << filename << " is truncated" << std::endl;
+        return false;
+    }
+    std::vector<real> values(count);
+    if (header.dtype == realDType() && !swapped)
+    {
+        // Тип и порядок байт совпадают: читаем все элементы одним блоком
+        file.read(reinterpret_cast<char*>(values.data()), (std::streamsize)(count * elem_size));
+    }
+    else
+    {
+        std::vector<unsigned char> raw(count * elem_size);
+        file.read(reinterpret_cast<char*>(raw.data()), (std::streamsize)raw.size());
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            unsigned char *elem = raw.data() + idx * elem_size;
+            if (swapped)
+            {
+                swapBytes(elem, elem_size);
+            }
+            if (header.dtype == MATRIX_FLOAT32)
+            {
+                float value;
+                std::memcpy(&value, elem, sizeof(value));
+                values[idx] = (real)value;
+            }
+            else
+            {
+                double value;
+                std::memcpy(&value, elem, sizeof(value));
+                values[idx] = (real)value;
+            }
+        }
+    }
+    if (!file)
+    {
+        std::cerr << "Matrix: file " << filename << " is truncated" << std::endl;
+        return false;
+    }
+    this->rows_ = (int)header.rows;
+    this->cols_ = (int)header.cols;
+    this->mvec_ = std::move(values);
+    return true;
+}
+
+/// @brief Оператор индексации представления матрицы
+/// @param row Строка
+/// @param col Столбец
+/// @return Значение в указанной строке и столбце
+real MatrixView::operator()(int row, int col) const
+{
+    if (row < 0 || row >= this->rows_ || col < 0 || col >= this->cols_)
+    {
+        std::cerr << "MatrixView: index out of bounds" << std::endl;
+        return 0;
+    }
+    return this->data_[(size_t)this->cols_ * row + col];
+}
+
+/// @brief Загружает файл с копированием данных, когда отображение
+/// без копирования невозможно. Представление становится владельцем загруженных элементов
+/// @param filename Путь к файлу
+/// @param rows Количество строк (результат)
+/// @param cols Количество столбцов (результат)
+/// @param data Указатель на загруженные элементы (результат)
+/// @param storage Владелец загруженных элементов (результат)
+/// @return True если матрица успешно загружена
+static bool loadView(const std::string &filename, int &rows, int &cols, const real *&data, std::shared_ptr<const void> &storage)
+{
+    Matrix matrix;
+    if (!matrix.load(filename))
+    {
+        return false;
+    }
+    rows = matrix.rows();
+    cols = matrix.cols();
+    auto values = std::make_shared<const Matrix>(std::move(matrix));
+    data = values->data();
+    storage = values;
+    return true;
+}
+
+/// @brief Отображает двоичный файл матрицы в память без копирования данных.
+/// Если формат данных в файле не совпадает с системным (или отображение
+/// файлов недоступно), файл загружается с копированием
+/// @param filename Путь к файлу
+/// @return True если матрица успешно отображена или загружена
+bool MatrixView::map(const std::string &filename)
+{
+#ifdef _WIN32
+    this->mapped_ = false;
+    return loadView(filename, this->rows_, this->cols_, this->data_, this->storage_);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Matrix: can't open file " << filename << std::endl;
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(MatrixFileHeader))
+    {
+        std::cerr << "Matrix: can't read header of file " << filename << std::endl;
+        ::close(fd);
+        return false;
+    }
+    size_t length = (size_t)st.st_size;
+    void *addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    // Отображение остается действительным после закрытия файла
+    ::close(fd);
+    if (addr == MAP_FAILED)
+    {
+        std::cerr << "Matrix: can't map file " << filename << " into memory" << std::endl;
+        return false;
+    }
+    std::shared_ptr<const void> mapping(addr, [length](const void *ptr) {
+        ::munmap(const_cast<void*>(ptr), length);
+    });
+    MatrixFileHeader header;
+    std::memcpy(&header, addr, sizeof(header));
+    bool swapped = false;
+    if (!checkHeader(header, swapped))
+    {
+        return false;
+    }
+    if (swapped || header.dtype != realDType())
+    {
+        // Данные требуют преобразования, поэтому представление без копирования невозможно
+        this->mapped_ = false;
+        return loadView(filename, this->rows_, this->cols_, this->data_, this->storage_);
+    }
+    size_t count = (size_t)(header.rows * header.cols);
+    if (length - sizeof(header) < count * sizeof(real))
+    {
+        std::cerr << "Matrix: file " << filename << " is truncated" << std::endl;
+        return false;
+    }
+    this->rows_ = (int)header.rows;
+    this->cols_ = (int)header.cols;
+    this->data_ = reinterpret_cast<const real*>(static_cast<const char*>(addr) + sizeof(header));
+    this->storage_ = std::move(mapping);
+    this->mapped_ = true;
+    return true;
+#endif
+}
+
+/// @brief Сохраняет представление матрицы в двоичный файл
+/// @param filename Путь к файлу
+/// @return True если матрица успешно сохранена
+bool MatrixView::save(const std::string &filename) const
+{
+    return writeMatrixFile(filename, this->rows_, this->cols_, this->data_);
+}
+
+/// @brief Возвращает изменяемую копию матрицы
+/// @return Матрица с копией элементов представления
+Matrix MatrixView::toMatrix() const
+{
+    return Matrix(this->rows_, this->cols_, std::vector<real>(this->data_, this->data_ + (size_t)this->rows_ * this->cols_));
+}
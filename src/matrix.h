@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
 #include <iostream>
+#include <cstddef>
+#include <string>
+#include <memory>
 
 // Пользовательский тип (псевдоним)
 typedef double real;
@@ -10,9 +13,9 @@ class Matrix
 {
 private:
     // Количество столбцов матрицы
-    int cols_;
+    int cols_ = 0;
     // Количество строк матрицы
-    int rows_;
+    int rows_ = 0;
     // Массив элементов матрицы
     std::vector<real> mvec_;
 public:
@@ -28,6 +31,16 @@ public:
     real operator()(int row, int col) const;        
     // Выводит матрицу на экран (стандартный вывод)
     void print();
+    // Возвращает количество строк матрицы
+    int rows() const { return rows_; };
+    // Возвращает количество столбцов матрицы
+    int cols() const { return cols_; };
+    // Возвращает указатель на непрерывный массив элементов матрицы
+    const real* data() const { return mvec_.data(); };
+    // Сохраняет матрицу в двоичный файл
+    bool save(const std::string &filename) const;
+    // Загружает матрицу из двоичного файла (с копированием данных)
+    bool load(const std::string &filename);
     // Оператор сложения матриц
     friend Matrix operator+(const Matrix& A, const Matrix& B);
     // Оператор вычитания матриц
@@ -40,12 +53,54 @@ public:
     Matrix& operator-=(const Matrix& A);
     // Оператор умножения матриц с присваиванием
     Matrix& operator*=(const Matrix& A);
+    // Применяет аффинное преобразование 3x3 к массиву точек (x,y) на месте
+    void transformPoints(real *xs, real *ys, size_t count) const;
+    // Применяет аффинное преобразование, заданное первыми двумя строками
+    // матрицы 3x3 (6 коэффициентов), к массиву точек (x,y) на месте
+    static void transformPoints(const real m[6], real *xs, real *ys, size_t count);
     // Оператор вывода объекта в поток
     friend std::ostream& operator<<(std::ostream &os, const Matrix &other);
     // Оператор ввода объекта из потока
     friend std::istream& operator>>(std::istream &is, Matrix &other);        
 };
 
+// Класс представления матрицы только для чтения. Элементы не копируются,
+// а читаются напрямую из отображенного в память двоичного файла
+class MatrixView
+{
+private:
+    // Количество столбцов матрицы
+    int cols_ = 0;
+    // Количество строк матрицы
+    int rows_ = 0;
+    // Элементы матрицы
+    const real *data_ = nullptr;
+    // Владелец элементов (отображение файла в память или загруженный массив),
+    // общий для всех копий представления
+    std::shared_ptr<const void> storage_;
+    // Признак того, что элементы читаются из отображенного файла
+    bool mapped_ = false;
+public:
+    // Конструктор по умолчанию (пустое представление)
+    MatrixView(){};
+    // Оператор индексирования
+    real operator()(int row, int col) const;
+    // Возвращает количество строк матрицы
+    int rows() const { return rows_; };
+    // Возвращает количество столбцов матрицы
+    int cols() const { return cols_; };
+    // Возвращает указатель на непрерывный массив элементов матрицы
+    const real* data() const { return data_; };
+    // Возвращает true, если элементы читаются из отображенного файла без копирования
+    bool isMapped() const { return mapped_; };
+    // Отображает двоичный файл матрицы в память
+    bool map(const std::string &filename);
+    // Сохраняет матрицу в двоичный файл
+    bool save(const std::string &filename) const;
+    // Возвращает изменяемую копию матрицы
+    Matrix toMatrix() const;
+};
+
 // Оператор сложения матриц
 Matrix operator+(const Matrix& A, const Matrix& B);
 // Оператор вычитания матриц
@@ -10,6 +10,7 @@
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QSpinBox>
+#include <QCheckBox>
 #include <QLabel>
 #include <QDir>
 #include <tuple>
@@ -25,6 +26,13 @@
 // Частота срабатывания таймера (мс)
 #define TIMER_INTERVAL 300
 
+// Количество столбцов большого поля
+#define GIANT_FIELD_COLS 100000
+// Количество строк большого поля
+#define GIANT_FIELD_ROWS 100000
+// Размер стороны чанка большого поля (в элементах поля)
+#define CHUNK_CELLS 32
+
 using namespace std;
 
 Window::Window(QWidget *parent) : QWidget(parent)
@@ -56,6 +64,10 @@ void Window::setupUI()
     // Угол должен быть в этом диапазоне
     this->step_angle->setRange(0,360);
     form->addRow("&Угол поворота:", this->step_angle);
+    // Флажок режима большого поля. При переключении игра начинается заново
+    this->giant_field = new QCheckBox();
+    form->addRow("&Большое поле:", this->giant_field);
+    connect(this->giant_field, SIGNAL(toggled(bool)), this, SLOT(giantFieldToggled()));
     // Layout для окна
     QVBoxLayout *vbox = new QVBoxLayout();
     // Добавляем пустую метку поверх игрового поля
@@ -84,10 +96,19 @@ void Window::loadImages()
 void Window::initGame() {
     // Изначально змея движется горизонтально 
     this->current_angle = 0;
-    // Размещаем яблоко
-    this->locateApple();
-    // Получаем произвольную позицию головы змеи
-    pair snakeHeadPos = getRandPos(this->surface->size().width()-COL_WIDTH,this->surface->size().height()-ROW_HEIGHT);
+    // Создаем большое поле, если включен этот режим
+    this->isGiantField = this->giant_field->isChecked();
+    this->field = this->isGiantField ?
+        Field(GIANT_FIELD_COLS*COL_WIDTH, GIANT_FIELD_ROWS*ROW_HEIGHT, CHUNK_CELLS*COL_WIDTH, CHUNK_CELLS*ROW_HEIGHT) :
+        Field();
+    // Змею удаляем заранее, чтобы она не мешала разместить яблоко
+    this->snakePos.clear();
+    // Получаем произвольную позицию головы змеи.
+    // На большом поле змея начинает игру в его центре
+    QSize size = this->fieldSize();
+    pair snakeHeadPos = this->isGiantField ?
+        pair<int,int>{size.width()/2, size.height()/2} :
+        getRandPos(size.width()-COL_WIDTH,size.height()-ROW_HEIGHT);
     // Подгоняем позицию под сетку COL_WIDTH x ROW_HEIGHT
     snakeHeadPos.first = (snakeHeadPos.first / COL_WIDTH) * COL_WIDTH;
     snakeHeadPos.second = (snakeHeadPos.second / ROW_HEIGHT) * ROW_HEIGHT;
@@ -96,6 +117,13 @@ void Window::initGame() {
     // Добавляем два сегмента к змее
     this->snakePos.push_back({snakeHeadPos.first-COL_WIDTH,snakeHeadPos.second});
     this->snakePos.push_back({snakeHeadPos.first-COL_WIDTH*2,snakeHeadPos.second});
+    if (this->isGiantField) {
+        for (auto &pos : this->snakePos) {
+            this->field.add(pos);
+        }
+    }
+    // Размещаем яблоко (на большом поле - в видимой области вокруг змеи)
+    this->locateApple();
     // Выходим из режима "Game Over"
     this->isGameOver = false;
     // Запускаем таймер
@@ -168,6 +196,12 @@ void Window::timerEvent()
             prevPos = swap;
         }
     }
+    if (this->isGiantField) {
+        // Множество занятых змеей позиций изменилось только в двух местах:
+        // добавилась новая позиция головы и освободилась прежняя позиция хвоста
+        this->field.remove(prevPos);
+        this->field.add(this->snakePos[0]);
+    }
     // перерисовываем окно
     this->repaint();
     // проверяем коллизии
@@ -181,59 +215,91 @@ void Window::timerEvent()
 /// @return Новая позицию (x,y)
 pair<int,int> Window::moveBy(pair<int,int> pos, int distance, int angle) {
     
-    // Матрица-столбец координат
-    Matrix coords_vector = Matrix(3,1, {
-        (double)pos.first,
-        (double)pos.second,
-        1        
-    });
-    
-    // Матрица-столбец перемещения
-    auto move_vector = Matrix(3,1, {        
-        (double)distance,
-        0,
-        1
-    });
+    // Координаты точки
+    real x = pos.first, y = pos.second;
 
-    // Матрица поворота
-    auto rotate_matrix = Matrix(3,3,{
-        cos(deg2rad(angle)),sin(deg2rad(angle)),0.,
-        -sin(deg2rad(angle)),cos(deg2rad(angle)),0.,
-        0.,0.,1. 
-    });
+    // Первые две строки аффинной матрицы перемещения: сдвиг на вектор
+    // (distance,0), повернутый на угол angle. Матрица хранится на стеке,
+    // поэтому перемещение не выделяет память
+    const real move_matrix[6] = {
+        1.,0.,cos(deg2rad(angle))*distance,
+        0.,1.,-sin(deg2rad(angle))*distance
+    };
 
-    // Поворачиваем вектор перемещения и прибавляем к вектору координат
-    auto result_matrix = coords_vector + rotate_matrix * move_vector;
+    // Перемещаем точку
+    Matrix::transformPoints(move_matrix,&x,&y,1);
 
     // Возвращаем новые координаты
-    return {(int)(result_matrix(0,0)),(int)(result_matrix(1,0))};
+    return {(int)x,(int)y};
 }
 
 /// @brief Отображает яблоко на поле
 void Window::locateApple() {
+    // Яблоко размещается в области, которую видит игрок. На обычном поле
+    // это все поле, на большом - видимая часть поля вокруг змеи
+    QRect area = QRect(QPoint(0,0),this->fieldSize());
+    if (this->isGiantField) {
+        area = area.intersected(this->viewport());
+    }
     // Получаем произвольную позицию яблока
-    this->applePos = getRandPos(this->surface->size().width()-COL_WIDTH,this->surface->size().height()-ROW_HEIGHT);    
+    this->applePos = getRandPos(area.width()-COL_WIDTH,area.height()-ROW_HEIGHT);
+    this->applePos.first += area.left();
+    this->applePos.second += area.top();
     // Подгоняем позицию под сетку COL_WIDTH x ROW_HEIGHT
     this->applePos.first = (this->applePos.first / COL_WIDTH) * COL_WIDTH;
     this->applePos.second = (this->applePos.second / ROW_HEIGHT) * ROW_HEIGHT;
-    // Если яблоко слишком близко к краям окна или оказалось под змеей,
+    // Если яблоко слишком близко к краям области или оказалось под змеей,
     // то вызываем функцию снова
-    if (this->applePos.first == 0 || this->applePos.second == 0 || 
-        this->applePos.first >= this->surface->size().width()-COL_WIDTH*2 || 
-        this->applePos.second >= this->surface->size().height()-ROW_HEIGHT*2 ||
+    if (this->applePos.first <= area.left() || this->applePos.second <= area.top() || 
+        this->applePos.first >= area.left()+area.width()-COL_WIDTH*2 || 
+        this->applePos.second >= area.top()+area.height()-ROW_HEIGHT*2 ||
         this->collideWithSnake(this->applePos)) {
             this->locateApple();
     }
 }
 
+/// @brief Возвращает размер игрового поля. Обычное поле совпадает
+/// с поверхностью игрового поля в окне, большое поле задается при старте игры
+/// @return Размер поля (в пикселях)
+QSize Window::fieldSize() {
+    if (this->isGiantField) {
+        return QSize(this->field.width(),this->field.height());
+    }
+    return this->surface->size();
+}
+
+/// @brief Возвращает область игрового поля, которая видна в окне.
+/// На большом поле камера следует за головой змеи, не выходя за границы поля
+/// @return Видимая область поля (в пикселях)
+QRect Window::viewport() {
+    QRect view = QRect(0,0,this->size().width(),this->surface->size().height());
+    if (!this->isGiantField || this->snakePos.empty()) {
+        return view;
+    }
+    auto [x,y] = this->snakePos[0];
+    int left = max(0,min(x - view.width()/2, this->field.width() - view.width()));
+    int top = max(0,min(y - view.height()/2, this->field.height() - view.height()));
+    view.moveTo(left,top);
+    return view;
+}
+
 /// @brief Функция перерисовки содержимого окна. Вызывается каждый раз когда необходимо перерисовать содержимое
 /// @param e Событие перерисовки окна
 void Window::paintEvent(QPaintEvent *e) {    
     QPainter painter;
     painter.begin(this);
+    // Видимая область поля. Рисуется только то, что в нее попадает,
+    // поэтому время отрисовки не зависит от размера поля
+    QRect view = this->viewport();
     // Рисуем поле
-    for (int y=0;y<this->surface->size().height();y+=ROW_HEIGHT) {
-        for (int x=0;x<this->size().width();x+=COL_WIDTH) {
+    QRect tiles = view;
+    if (this->isGiantField) {
+        // За границами большого поля фон не рисуем
+        tiles = tiles.intersected(QRect(QPoint(0,0),this->fieldSize()));
+    }
+    painter.translate(-view.topLeft());
+    for (int y=(tiles.top()/ROW_HEIGHT)*ROW_HEIGHT;y<tiles.top()+tiles.height();y+=ROW_HEIGHT) {
+        for (int x=(tiles.left()/COL_WIDTH)*COL_WIDTH;x<tiles.left()+tiles.width();x+=COL_WIDTH) {
             painter.drawPixmap(x,y, this->bg_image);
         }
     }    
@@ -243,14 +309,23 @@ void Window::paintEvent(QPaintEvent *e) {
         
         // Рисуем яблоко
         painter.drawPixmap(this->applePos.first, this->applePos.second, this->apple_image);                    
-        // Рисуем змею
-        for (int idx=0;idx<this->snakePos.size();++idx) {
-            auto [x,y] = this->snakePos[idx];
-            painter.drawPixmap(x,y,this->snake_image.transformed(QTransform().rotate(this->current_angle)));
-                       
+        // Рисуем змею. Все сегменты повернуты на один угол,
+        // поэтому изображение поворачиваем один раз
+        QPixmap segment_image = this->snake_image.transformed(QTransform().rotate(this->current_angle));
+        // На большом поле берем только сегменты из чанков, попадающих в видимую область
+        // (с запасом на размер сегмента, который может выступать из соседнего чанка)
+        vector<pair<int,int>> visible;
+        if (this->isGiantField) {
+            visible = this->field.find(view.adjusted(-COL_WIDTH,-ROW_HEIGHT,0,0));
+        }
+        const vector<pair<int,int>> &segments = this->isGiantField ? visible : this->snakePos;
+        for (int idx=0;idx<segments.size();++idx) {
+            auto [x,y] = segments[idx];
+            painter.drawPixmap(x,y,segment_image);
         }
     } else {
         // Если игра закончена, то просто пишем "GAME OVER"
+        painter.resetTransform();
 
         // Устанавливаем шрифт
         QFont font = QFont();
@@ -268,9 +343,10 @@ void Window::paintEvent(QPaintEvent *e) {
 /// @brief Проверяет столкновения змеи
 void Window::checkCollision()
 {
-    // столкновение с границами окна и со своим телом
+    // столкновение с границами поля и со своим телом
     auto [x,y] = this->snakePos[0];
-    if (x<=0 || y<=0 || x>=this->surface->size().width() || y>=this->surface->size().height() || this->collideWithSnake(this->snakePos[0])) { 
+    QSize size = this->fieldSize();
+    if (x<=0 || y<=0 || x>=size.width() || y>=size.height() || this->collideWithSnake(this->snakePos[0])) { 
         // завершение игры
         this->gameOver(); 
         return;
@@ -294,6 +370,22 @@ void Window::checkCollision()
 /// @return True если пересекается
 bool Window::collideWithSnake(pair<int,int> pos)
 {
+    if (this->isGiantField && !this->snakePos.empty()) {
+        // На большом поле проверяем только сегменты из чанков рядом с точкой
+        auto segments = this->field.find(QRect(pos.first-COL_WIDTH,pos.second-ROW_HEIGHT,COL_WIDTH*3,ROW_HEIGHT*3));
+        // Голова змеи тоже лежит на поле, ее пропускаем один раз
+        bool headSkipped = false;
+        for (auto &segment : segments) {
+            if (!headSkipped && segment == this->snakePos[0]) {
+                headSkipped = true;
+                continue;
+            }
+            if (this->intersection(pos,segment) > 20) {
+                return true;
+            }
+        }
+        return false;
+    }
     for (int idx=1;idx<this->snakePos.size();++idx) {
         // Вычисляем площадь области пересечения объекта в позиции pos с каждым
         // сегментом тела змеи кроме первого
@@ -311,6 +403,9 @@ void Window::extendBody()
 {
     auto [x,y] = this->snakePos[this->snakePos.size()-1];
     this->snakePos.push_back({x+COL_WIDTH, y});
+    if (this->isGiantField) {
+        this->field.add(this->snakePos.back());
+    }
 }
 
 /// @brief Завершает игру
@@ -343,6 +438,14 @@ int Window::intersection(pair<int,int> &box1, pair<int,int> &box2)
     return max(0,x2-x1)*max(0,y2-y1);    
 }
 
+/// @brief Обработчик переключения режима большого поля, начинает игру заново
+void Window::giantFieldToggled()
+{
+    this->initGame();
+    // Возвращаем фокус на поверхность игрового поля
+    this->surface->setFocus();
+}
+
 /// @brief Обработчик события щелчка мыши в окне
 /// @param event 
 void Window::mousePressEvent(QMouseEvent *event)
@@ -3,7 +3,9 @@
 #include <QTimer>
 #include <QLabel>
 #include <QSpinBox>
+#include <QCheckBox>
 #include "matrix.h"
+#include "field.h"
 
 using namespace std;
 
@@ -20,6 +22,9 @@ private:
     // Поле ввода значения угла, на которое меняется угол
     // под которым движется змея при управлении
     QSpinBox *step_angle;
+    // Флажок режима большого поля, которое больше экрана
+    // и прокручивается вслед за головой змеи
+    QCheckBox *giant_field;
     // Изображения
     // Фон
     QPixmap bg_image;
@@ -34,6 +39,14 @@ private:
     vector<pair<int,int>> snakePos;
     // Признак того, что игра завершена
     bool isGameOver;
+    // Признак того, что игра идет на большом поле
+    bool isGiantField = false;
+    // Сегменты змеи на большом поле, разложенные по чанкам
+    Field field;
+    // Метод возвращает размер игрового поля
+    QSize fieldSize();
+    // Метод возвращает видимую в окне область игрового поля
+    QRect viewport();
     // Метод загрузки изображений из файлов
     void loadImages();
     // Метод проверяет столкновения змеи с другими объектами
@@ -62,6 +75,8 @@ private:
 private slots:
     // Метод обработки события таймера
     void timerEvent();
+    // Метод обработки переключения режима большого поля
+    void giantFieldToggled();
 protected:
     // Метод обработки нажатия клавиши на клавиатуре
     void keyPressEvent(QKeyEvent *e);
@@ -0,0 +1,185 @@
+/**
+ * Проверка преобразования массивов точек, а также
+ * сохранения и загрузки матриц в двоичном формате
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include "../src/matrix.h"
+
+// Количество проваленных проверок
+static int failures = 0;
+
+// Проверяет условие и выводит сообщение, если оно не выполнено
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " << #condition << std::endl; \
+            ++failures; \
+        } \
+    } while (0)
+
+/// @brief Записывает значение в поток с указанным порядком байт
+/// @param os Поток вывода
+/// @param value Значение
+/// @param swapped Если true, байты записываются в обратном порядке
+template <typename T>
+static void writeValue(std::ostream &os, T value, bool swapped)
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if (swapped)
+    {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    os.write(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+/// @brief Записывает файл матрицы 2x2 вручную, в обход Matrix::save
+/// @param filename Путь к файлу
+/// @param values Элементы матрицы
+/// @param swapped Если true, файл записывается в порядке байт, обратном системному
+template <typename T>
+static void writeFile(const std::string &filename, const T (&values)[4], bool swapped)
+{
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write("MTRX", 4);
+    writeValue<uint32_t>(file, 0x01020304u, swapped);
+    writeValue<uint32_t>(file, 1, swapped);
+    writeValue<uint32_t>(file, sizeof(T) == sizeof(float) ? 1 : 2, swapped);
+    writeValue<uint64_t>(file, 2, swapped);
+    writeValue<uint64_t>(file, 2, swapped);
+    for (T value : values)
+    {
+        writeValue<T>(file, value, swapped);
+    }
+}
+
+/// @brief Проверяет, что матрица 2x2 содержит значения 1.5, -2, 0.25, 8
+/// @param matrix Матрица или представление матрицы
+template <typename M>
+static void checkValues(const M &matrix)
+{
+    CHECK(matrix.rows() == 2 && matrix.cols() == 2);
+    if (matrix.rows() == 2 && matrix.cols() == 2)
+    {
+        CHECK(matrix(0,0) == 1.5);
+        CHECK(matrix(0,1) == -2);
+        CHECK(matrix(1,0) == 0.25);
+        CHECK(matrix(1,1) == 8);
+    }
+}
+
+/// @brief Проверяет оба варианта transformPoints на указанном количестве точек.
+/// Коэффициенты и координаты точно представимы в double, поэтому результат
+/// векторного и многопоточного вариантов должен совпадать с формулой точно
+/// @param count Количество точек
+static void checkTransform(size_t count)
+{
+    const real m[6] = {0.5, -1.25, 3, 2, 0.75, -4};
+    std::vector<real> xs(count), ys(count);
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        xs[idx] = (real)(idx % 1000);
+        ys[idx] = (real)(idx % 777) - 300;
+    }
+    std::vector<real> static_xs = xs, static_ys = ys;
+    Matrix::transformPoints(m, static_xs.data(), static_ys.data(), count);
+    std::vector<real> member_xs = xs, member_ys = ys;
+    Matrix(3,3,{m[0],m[1],m[2],m[3],m[4],m[5],0,0,1}).transformPoints(member_xs.data(), member_ys.data(), count);
+    size_t errors = 0;
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        real x = m[0] * xs[idx] + m[1] * ys[idx] + m[2];
+        real y = m[3] * xs[idx] + m[4] * ys[idx] + m[5];
+        if (static_xs[idx] != x || static_ys[idx] != y || member_xs[idx] != x || member_ys[idx] != y)
+        {
+            ++errors;
+        }
+    }
+    CHECK(errors == 0);
+}
+
+int main()
+{
+    // Преобразование точек: пустой массив, хвосты после векторного ядра
+    // и многопоточное разбиение, не кратное количеству потоков
+    for (size_t count : {0, 1, 2, 3, 4, 5, 7, 9, 65536, 200003})
+    {
+        checkTransform(count);
+    }
+    // Матрица не 3x3 не должна менять точки
+    {
+        real xs[3] = {1, 2, 3}, ys[3] = {4, 5, 6};
+        Matrix(2,3,{1,2,3,4,5,6}).transformPoints(xs, ys, 3);
+        CHECK(xs[0] == 1 && xs[1] == 2 && xs[2] == 3);
+        CHECK(ys[0] == 4 && ys[1] == 5 && ys[2] == 6);
+    }
+
+    const std::string filename = "matrix_test.bin";
+
+    // Сохранение, загрузка и отображение в память в системном формате
+    Matrix source(2,2,{1.5,-2,0.25,8});
+    CHECK(source.save(filename));
+    Matrix loaded;
+    CHECK(loaded.load(filename));
+    checkValues(loaded);
+    MatrixView view;
+    CHECK(view.map(filename));
+    CHECK(view.isMapped());
+    checkValues(view);
+    checkValues(view.toMatrix());
+
+    // Сохранение представления в файл, из которого оно отображено
+    CHECK(view.save(filename));
+    checkValues(view);
+    CHECK(loaded.load(filename));
+    checkValues(loaded);
+
+    // Перед перезаписью файла освобождаем его отображение
+    view = MatrixView();
+
+    // Элементы float32
+    writeFile<float>(filename, {1.5f,-2.f,0.25f,8.f}, false);
+    CHECK(loaded.load(filename));
+    checkValues(loaded);
+    CHECK(view.map(filename));
+    checkValues(view);
+
+    // Обратный порядок байт (float64 и float32)
+    writeFile<double>(filename, {1.5,-2.,0.25,8.}, true);
+    CHECK(loaded.load(filename));
+    checkValues(loaded);
+    CHECK(view.map(filename));
+    CHECK(!view.isMapped());
+    checkValues(view);
+    writeFile<float>(filename, {1.5f,-2.f,0.25f,8.f}, true);
+    CHECK(loaded.load(filename));
+    checkValues(loaded);
+
+    // Файл короче, чем указано в заголовке
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file.write("MTRX", 4);
+        writeValue<uint32_t>(file, 0x01020304u, false);
+        writeValue<uint32_t>(file, 1, false);
+        writeValue<uint32_t>(file, 2, false);
+        writeValue<uint64_t>(file, 46340, false);
+        writeValue<uint64_t>(file, 46340, false);
+    }
+    CHECK(!loaded.load(filename));
+    CHECK(!view.map(filename));
+
+    std::remove(filename.c_str());
+    if (failures > 0)
+    {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}